@@ -38,12 +38,14 @@ class LSPTest:
 class Expected:
     type: Result
     value: Union[int, str, None]
+    flags: str = ""
 
 
 def get_expected(filename) -> Optional[Expected]:
     with open(filename, encoding="utf8", errors='ignore') as file:
         is_lsp = False
         lsp_flags = ""
+        flags = ""
 
         for line in file:
             if not line.startswith("///"):
@@ -55,7 +57,7 @@ def get_expected(filename) -> Optional[Expected]:
             if line == "skip":
                 return Expected(Result.SKIP_SILENTLY, None)
             if line == "compile":
-                return Expected(Result.COMPILE_SUCCESS, None)
+                return Expected(Result.COMPILE_SUCCESS, None, flags)
             if line == "test_mode_pass":
                 return Expected(Result.TEST_MODE_PASS, None)
             if line == "":
@@ -68,14 +70,18 @@ def get_expected(filename) -> Optional[Expected]:
             # Commands with arguments
             name, value = map(str.strip, line.split(":", 1))
 
+            # Extra compiler flags, followed by one of the other commands
+            if name == "flags":
+                flags = value
+                continue
             if name == "exit":
-                return Expected(Result.EXIT_WITH_CODE, int(value))
+                return Expected(Result.EXIT_WITH_CODE, int(value), flags)
             if name == "out":
-                return Expected(Result.EXIT_WITH_OUTPUT, value)
+                return Expected(Result.EXIT_WITH_OUTPUT, value, flags)
             if name == "fail":
-                return Expected(Result.COMPILE_FAIL, value)
+                return Expected(Result.COMPILE_FAIL, value, flags)
             if name == "runfail":
-                return Expected(Result.RUNTIME_FAIL, value)
+                return Expected(Result.RUNTIME_FAIL, value, flags)
             if name == "lsp":
                 is_lsp = True
                 lsp_flags = value
@@ -195,7 +201,7 @@ def handle_test(compiler: str, num: int, path: Path, expected: Expected, debug:
         print(f"[{num}] {path} || {exec_name}", flush=True)
 
     process = run(
-        [compiler, str(path), '-o', exec_name],
+        [compiler, str(path), '-o', exec_name, *shlex.split(expected.flags)],
         stdout=PIPE,
         stderr=PIPE
     )
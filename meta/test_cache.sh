@@ -0,0 +1,68 @@
+#!/bin/bash
+
+# Checks that the object cache (`--cache`) reuses objects for unchanged code, and rebuilds them
+# when the program, an included header or the flags change.
+#
+# Usage: ./meta/test_cache.sh [compiler]
+
+set -e
+
+COMPILER=$(realpath "${1:-./bootstrap/ocen}")
+export OCEN_ROOT=$(realpath "$(dirname "$0")/..")
+
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+cd "$DIR"
+
+FAILED=0
+
+# build <expected hits> <expected misses> <expected output> [flags...]
+build() {
+    local hits=$1 misses=$2 expected=$3
+    shift 3
+    local log
+    log=$("$COMPILER" main.oc -o main --cache cache "$@" 2>&1)
+    if ! grep -q "Object cache: $hits hits, $misses misses" <<< "$log"; then
+        echo "[-] Expected $hits hits and $misses misses, got: $(grep 'Object cache' <<< "$log")"
+        FAILED=1
+    fi
+    local output
+    output=$(./main)
+    if [[ "$output" != "$expected" ]]; then
+        echo "[-] Expected output '$expected', got '$output'"
+        FAILED=1
+    fi
+}
+
+cat > main.oc <<'EOF'
+@compiler c_include "value.h"
+
+[extern "VALUE"] let VALUE: i32
+
+def main() {
+    println(f"{VALUE}")
+}
+EOF
+echo '#define VALUE 1' > value.h
+
+echo "[+] Cold cache"
+build 0 2 1
+echo "[+] Unchanged program"
+build 2 0 1
+echo "[+] Changed header"
+echo '#define VALUE 2' > value.h
+build 0 2 2
+echo "[+] Header changed back"
+echo '#define VALUE 1' > value.h
+build 2 0 1
+echo "[+] Different flags"
+build 0 2 1 --cflags -DUNUSED
+echo "[+] Changed program"
+sed -i 's/f"{VALUE}"/f"value: {VALUE}"/' main.oc
+build 1 1 "value: 1"
+
+if [[ $FAILED -ne 0 ]]; then
+    echo "[-] Object cache tests failed"
+    exit 1
+fi
+echo "[+] Object cache tests passed"
@@ -5,6 +5,9 @@
  * we cannot do natively in Ocen right now.
 */
 
+// NOTE: Definitions here are weak, since the compiler includes embedded files in every
+//       translation unit when splitting the output (`-j N`).
+
 // NOTE: Emscripten expects a callback that doesn't return anything,
 //       but we want to be able to return a boolean to indicate when
 //       the main loop should stop. We'll use a wrapper function to
@@ -15,9 +18,9 @@
 #include <emscripten.h>
 #include <emscripten/html5.h>
 
-_Bool (*callback)(void) = NULL;
+OC_WEAK _Bool (*callback)(void) = NULL;
 // EMS no-return callback wrapper
-void ems_callback() {
+OC_WEAK void ems_callback() {
     if (callback) callback();
 }
 static _Bool IS_IN_WASM = 1;
@@ -25,7 +28,7 @@ static _Bool IS_IN_WASM = 1;
 static _Bool IS_IN_WASM = 0;
 #endif
 
-void c_set_main_loop(_Bool (*func)(void)) {
+OC_WEAK void c_set_main_loop(_Bool (*func)(void)) {
 #ifdef __EMSCRIPTEN__
     callback = func;
     emscripten_set_main_loop(ems_callback, 0, 1);
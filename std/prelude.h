@@ -17,19 +17,23 @@ typedef uint64_t u64;
 typedef float f32;
 typedef double f64;
 
-const char* __asan_default_options() { return "detect_leaks=0"; }
+// Definitions in here are marked weak, since the compiler may include this file in
+// multiple translation units when splitting the output (`-j N`).
+#define OC_WEAK __attribute__((weak))
+
+OC_WEAK const char* __asan_default_options() { return "detect_leaks=0"; }
 
 //// Backtraces
 
-volatile static const char *__oc_bt[] = {0};
-volatile u64 __oc_bt_idx = 0;
+OC_WEAK volatile const char *__oc_bt[] = {0};
+OC_WEAK volatile u64 __oc_bt_idx = 0;
 
 #define _WITH_BT(s, ...)      \
   __oc_bt[__oc_bt_idx++] = s; \
   __VA_ARGS__;                \
   (void)__oc_bt_idx--;
 
-void dump_backtrace() {
+OC_WEAK void dump_backtrace() {
   if (__oc_bt_idx == 0) {
     return;
   }
@@ -50,7 +54,10 @@ void dump_backtrace() {
   #define oc_trap __builtin_trap
 #endif
 
-void ae_assert_fail(char *dbg_msg, char *msg) {
+#define oc_likely(x) __builtin_expect(!!(x), 1)
+#define oc_unlikely(x) __builtin_expect(!!(x), 0)
+
+OC_WEAK void ae_assert_fail(char *dbg_msg, char *msg) {
   dump_backtrace();
   fprintf(stderr, "--------------------------------------------------------------------------------\n");
   fprintf(stderr, "%s\n", dbg_msg);
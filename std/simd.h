@@ -0,0 +1,185 @@
+#ifndef OC_SIMD_H
+#define OC_SIMD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// 256-bit vectors are passed differently with and without AVX, which GCC warns about. All the
+// functions here are `static inline`, so they never cross an ABI boundary.
+#if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+// This only uses standard C types, so it doesn't depend on the prelude being embedded first.
+
+// Vector types use GCC / Clang vector extensions, or plain structs with one field per lane
+// when building with `--no-simd` (which defines OC_NO_SIMD), or with other compilers.
+// Everything below is written so that it works with either representation.
+
+#if defined(OC_NO_SIMD) || !(defined(__GNUC__) || defined(__clang__))
+  #define OC_SIMD_SCALAR 1
+#endif
+
+#ifdef OC_SIMD_SCALAR
+  #define OC_SIMD_TYPEDEF(T, E, N) typedef struct { E v[N]; } T;
+  #define OC_LANE(x, i) ((x).v[i])
+  #define OC_SIMD_MAKE(T, ...) ((T){{__VA_ARGS__}})
+#else
+  #define OC_SIMD_TYPEDEF(T, E, N) typedef E T __attribute__((vector_size(sizeof(E) * N)));
+  #define OC_LANE(x, i) ((x)[i])
+  #define OC_SIMD_MAKE(T, ...) ((T){__VA_ARGS__})
+#endif
+
+OC_SIMD_TYPEDEF(f32x4, float, 4)
+OC_SIMD_TYPEDEF(f32x8, float, 8)
+OC_SIMD_TYPEDEF(f64x2, double, 2)
+OC_SIMD_TYPEDEF(f64x4, double, 4)
+OC_SIMD_TYPEDEF(i8x16, int8_t, 16)
+OC_SIMD_TYPEDEF(u8x16, uint8_t, 16)
+OC_SIMD_TYPEDEF(i32x4, int32_t, 4)
+OC_SIMD_TYPEDEF(i32x8, int32_t, 8)
+OC_SIMD_TYPEDEF(u32x4, uint32_t, 4)
+OC_SIMD_TYPEDEF(i64x2, int64_t, 2)
+OC_SIMD_TYPEDEF(i64x4, int64_t, 4)
+
+#ifdef OC_SIMD_SCALAR
+  #define OC_SIMD_BINOP(T, N, name, op)                                         \
+    static inline T oc_##T##_##name(T a, T b) {                                 \
+      T r;                                                                      \
+      for (int i = 0; i < N; i++) r.v[i] = a.v[i] op b.v[i];                    \
+      return r;                                                                 \
+    }
+  #define OC_SIMD_CMP(T, M, N, name, op)                                        \
+    static inline M oc_##T##_##name(T a, T b) {                                 \
+      M r;                                                                      \
+      for (int i = 0; i < N; i++) r.v[i] = (a.v[i] op b.v[i]) ? -1 : 0;        \
+      return r;                                                                 \
+    }
+  #define OC_SIMD_SELECT(T, M, N)                                               \
+    static inline T oc_##T##_select(M m, T a, T b) {                            \
+      T r;                                                                      \
+      for (int i = 0; i < N; i++) r.v[i] = m.v[i] ? a.v[i] : b.v[i];            \
+      return r;                                                                 \
+    }
+#else
+  #define OC_SIMD_BINOP(T, N, name, op)                                         \
+    static inline T oc_##T##_##name(T a, T b) { return a op b; }
+  #define OC_SIMD_CMP(T, M, N, name, op)                                        \
+    static inline M oc_##T##_##name(T a, T b) { return (M)(a op b); }
+  // Casting between vectors of the same size keeps the bits. Any non-zero lane of
+  // the mask selects `a`, like the scalar fallback, so it's widened to all ones first.
+  #define OC_SIMD_SELECT(T, M, N)                                               \
+    static inline T oc_##T##_select(M m, T a, T b) {                            \
+      M n = (M)(m != 0);                                                        \
+      return (T)(((M)a & n) | ((M)b & ~n));                                     \
+    }
+#endif
+
+#if !defined(OC_SIMD_SCALAR) && !defined(__clang__)
+  #define OC_SIMD_SHUFFLE(T, M, N)                                              \
+    static inline T oc_##T##_shuffle(T a, M idx) { return __builtin_shuffle(a, idx); }
+#else
+  #define OC_SIMD_SHUFFLE(T, M, N)                                              \
+    static inline T oc_##T##_shuffle(T a, M idx) {                              \
+      T r;                                                                      \
+      for (int i = 0; i < N; i++) OC_LANE(r, i) = OC_LANE(a, OC_LANE(idx, i) & (N - 1)); \
+      return r;                                                                 \
+    }
+#endif
+
+// T: vector type, E: element type, N: number of lanes, M: mask type (same size integer lanes)
+#define OC_SIMD_OPS(T, E, N, M)                                                 \
+  static inline T oc_##T##_splat(E x) {                                         \
+    T r;                                                                        \
+    for (int i = 0; i < N; i++) OC_LANE(r, i) = x;                              \
+    return r;                                                                   \
+  }                                                                             \
+  static inline T oc_##T##_load(const E *p) {                                   \
+    T r;                                                                        \
+    memcpy(&r, p, sizeof(E) * N);                                               \
+    return r;                                                                   \
+  }                                                                             \
+  static inline void oc_##T##_store(T a, E *p) { memcpy(p, &a, sizeof(E) * N); } \
+  static inline E oc_##T##_get(T a, uint32_t i) { return OC_LANE(a, i); }            \
+  static inline void oc_##T##_set(T *a, uint32_t i, E x) { OC_LANE(*a, i) = x; }     \
+  OC_SIMD_BINOP(T, N, add, +)                                                   \
+  OC_SIMD_BINOP(T, N, sub, -)                                                   \
+  OC_SIMD_BINOP(T, N, mul, *)                                                   \
+  OC_SIMD_BINOP(T, N, div, /)                                                   \
+  static inline T oc_##T##_adds(T a, E b) { return oc_##T##_add(a, oc_##T##_splat(b)); } \
+  static inline T oc_##T##_subs(T a, E b) { return oc_##T##_sub(a, oc_##T##_splat(b)); } \
+  static inline T oc_##T##_muls(T a, E b) { return oc_##T##_mul(a, oc_##T##_splat(b)); } \
+  static inline T oc_##T##_divs(T a, E b) { return oc_##T##_div(a, oc_##T##_splat(b)); } \
+  static inline T oc_##T##_addrs(E a, T b) { return oc_##T##_add(oc_##T##_splat(a), b); } \
+  static inline T oc_##T##_subrs(E a, T b) { return oc_##T##_sub(oc_##T##_splat(a), b); } \
+  static inline T oc_##T##_mulrs(E a, T b) { return oc_##T##_mul(oc_##T##_splat(a), b); } \
+  static inline T oc_##T##_divrs(E a, T b) { return oc_##T##_div(oc_##T##_splat(a), b); } \
+  static inline T oc_##T##_neg(T a) { return oc_##T##_sub(oc_##T##_splat(0), a); } \
+  OC_SIMD_CMP(T, M, N, eq, ==)                                                  \
+  OC_SIMD_CMP(T, M, N, ne, !=)                                                  \
+  OC_SIMD_CMP(T, M, N, lt, <)                                                   \
+  OC_SIMD_CMP(T, M, N, le, <=)                                                  \
+  OC_SIMD_CMP(T, M, N, gt, >)                                                   \
+  OC_SIMD_CMP(T, M, N, ge, >=)                                                  \
+  OC_SIMD_SELECT(T, M, N)                                                       \
+  OC_SIMD_SHUFFLE(T, M, N)                                                      \
+  static inline T oc_##T##_min(T a, T b) { return oc_##T##_select(oc_##T##_lt(a, b), a, b); } \
+  static inline T oc_##T##_max(T a, T b) { return oc_##T##_select(oc_##T##_gt(a, b), a, b); } \
+  static inline E oc_##T##_sum(T a) {                                           \
+    E r = 0;                                                                    \
+    for (int i = 0; i < N; i++) r += OC_LANE(a, i);                             \
+    return r;                                                                   \
+  }
+
+// Only for integer lanes
+#define OC_SIMD_INT_OPS(T, N)                                                   \
+  OC_SIMD_BINOP(T, N, and, &)                                                   \
+  OC_SIMD_BINOP(T, N, or, |)                                                    \
+  OC_SIMD_BINOP(T, N, xor, ^)                                                   \
+  static inline T oc_##T##_not(T a) { return oc_##T##_xor(a, oc_##T##_splat(-1)); } \
+  static inline bool oc_##T##_any(T a) {                                        \
+    for (int i = 0; i < N; i++) if (OC_LANE(a, i)) return true;                 \
+    return false;                                                               \
+  }                                                                             \
+  static inline bool oc_##T##_all(T a) {                                        \
+    for (int i = 0; i < N; i++) if (!OC_LANE(a, i)) return false;               \
+    return true;                                                                \
+  }
+
+OC_SIMD_OPS(f32x4, float, 4, i32x4)
+OC_SIMD_OPS(f32x8, float, 8, i32x8)
+OC_SIMD_OPS(f64x2, double, 2, i64x2)
+OC_SIMD_OPS(f64x4, double, 4, i64x4)
+OC_SIMD_OPS(i8x16, int8_t, 16, i8x16)
+OC_SIMD_OPS(u8x16, uint8_t, 16, i8x16)
+OC_SIMD_OPS(i32x4, int32_t, 4, i32x4)
+OC_SIMD_OPS(i32x8, int32_t, 8, i32x8)
+OC_SIMD_OPS(u32x4, uint32_t, 4, i32x4)
+OC_SIMD_OPS(i64x2, int64_t, 2, i64x2)
+OC_SIMD_OPS(i64x4, int64_t, 4, i64x4)
+
+OC_SIMD_INT_OPS(i8x16, 16)
+OC_SIMD_INT_OPS(u8x16, 16)
+OC_SIMD_INT_OPS(i32x4, 4)
+OC_SIMD_INT_OPS(i32x8, 8)
+OC_SIMD_INT_OPS(u32x4, 4)
+OC_SIMD_INT_OPS(i64x2, 2)
+OC_SIMD_INT_OPS(i64x4, 4)
+
+#define oc_f32x4_make(...) OC_SIMD_MAKE(f32x4, __VA_ARGS__)
+#define oc_f32x8_make(...) OC_SIMD_MAKE(f32x8, __VA_ARGS__)
+#define oc_f64x2_make(...) OC_SIMD_MAKE(f64x2, __VA_ARGS__)
+#define oc_f64x4_make(...) OC_SIMD_MAKE(f64x4, __VA_ARGS__)
+#define oc_i32x4_make(...) OC_SIMD_MAKE(i32x4, __VA_ARGS__)
+#define oc_i32x8_make(...) OC_SIMD_MAKE(i32x8, __VA_ARGS__)
+#define oc_u32x4_make(...) OC_SIMD_MAKE(u32x4, __VA_ARGS__)
+#define oc_i64x2_make(...) OC_SIMD_MAKE(i64x2, __VA_ARGS__)
+#define oc_i64x4_make(...) OC_SIMD_MAKE(i64x4, __VA_ARGS__)
+
+#if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic pop
+#endif
+
+#endif // OC_SIMD_H
@@ -0,0 +1,8 @@
+/// skip
+
+// Embeds end up in every unit with `-j`, see `tests/split_units/main.oc`
+OC_WEAK int embed_counter = 0;
+
+OC_WEAK int embed_next() {
+    return ++embed_counter;
+}